@@ -2,6 +2,13 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
+#ifdef USE_NUMBER
+#include "esphome/components/number/number.h"
+#endif
+
 namespace esphome
 {
     namespace century_vs_pump
@@ -27,9 +34,153 @@ namespace esphome
             return true;
         }
 
+        // Code tables for the native status/fault text sensors, kept in flash
+        struct CodeName
+        {
+            uint8_t code;
+            const char *name;
+        };
+
+        static const CodeName MOTOR_STATUS_NAMES[] = {
+            {0x00, "Stopped"},
+            {0x09, "Starting"},
+            {0x0B, "Running"},
+            {0x20, "Fault"},
+        };
+
+        static const CodeName PRIME_STATUS_NAMES[] = {
+            {0, "Idle"},
+            {1, "Priming"},
+            {2, "Complete"},
+        };
+
+        static const CodeName FAULT_NAMES[] = {
+            {0x00, "None"},
+            {0x21, "Overcurrent"},
+            {0x22, "DC Overvoltage"},
+            {0x2E, "IGBT Overtemp"},
+            {0x3E, "Comm Loss"},
+            {0x3F, "Generic Fault"},
+            {0x40, "Coherence Fault"},
+            {0x41, "UL Fault"},
+        };
+
+        template <size_t N>
+        static const char *find_code_name(const CodeName (&names)[N], uint16_t code)
+        {
+            for (const auto &entry : names)
+            {
+                if (entry.code == code)
+                    return entry.name;
+            }
+            return nullptr;
+        }
+
+        static std::string describe_code(CodeTable table, uint16_t code)
+        {
+            const char *name = nullptr;
+            switch (table)
+            {
+            case CODE_MOTOR_STATUS:
+                name = find_code_name(MOTOR_STATUS_NAMES, code);
+                break;
+            case CODE_PRIME_STATUS:
+                name = find_code_name(PRIME_STATUS_NAMES, code);
+                break;
+            case CODE_PREVIOUS_FAULT:
+                name = find_code_name(FAULT_NAMES, code);
+                break;
+            default:
+                break;
+            }
+            if (name != nullptr)
+                return name;
+
+            char buf[16];
+            snprintf(buf, sizeof(buf), "Code 0x%02X", code);
+            return buf;
+        }
+
+        // Appends the request payload for a 0x45 sensor read or 0x64 config read
+        static void append_read_payload(std::vector<uint8_t> &payload, uint8_t function, uint8_t page, uint8_t address, uint8_t width)
+        {
+            switch (function)
+            {
+            case 0x45: // Read sensor
+                payload.push_back(page);
+                payload.push_back(address);
+                break;
+            case 0x64:                         // Config Read/Write
+                payload.push_back(page);       // Page (MSBit=0 for read)
+                payload.push_back(address);
+                payload.push_back(width - 1); // Length 0 = 1 byte, 1 = 2 bytes
+                break;
+            default: // 0x43 Pump status has no payload
+                break;
+            }
+        }
+
+        // Decodes the raw value from a 0x45 sensor read or 0x64 config read reply (function and ACK stripped).
+        // Returns false and logs if the reply is short or does not match the request.
+        static bool decode_read_reply(uint8_t function, uint8_t page, uint8_t address, uint8_t width, const std::vector<uint8_t> &data, uint16_t &value)
+        {
+            if (function == 0x45)
+            {
+                // Response format: page, address, value (1-2 bytes)
+                if (!validate_response_size(data, 3, "Sensor read"))
+                    return false;
+
+                value = (uint16_t)data[2];
+                if (data.size() >= 4)
+                {
+                    // Two-byte sensor value (little-endian)
+                    value |= (uint16_t)data[3] << 8;
+                }
+                ESP_LOGD(TAG, "Read value %d from page %d, addr %d", value, page, address);
+                return true;
+            }
+
+            // Response format: page, address, length, data (1-2 bytes, little-endian)
+            if (!validate_response_size(data, 3 + width, "Config read"))
+                return false;
+
+            // Validate response matches request (guards against line noise/corruption)
+            if (data[0] != page || data[1] != address)
+            {
+                ESP_LOGW(TAG, "Config read response mismatch: expected page %d addr %d, got page %d addr %d",
+                         page, address, data[0], data[1]);
+                return false;
+            }
+
+            value = (uint16_t)data[3];
+            if (width > 1)
+                value |= (uint16_t)data[4] << 8;
+            ESP_LOGD(TAG, "Config read page %d, addr %d = %d", page, address, value);
+            return true;
+        }
+
         /////////////////////////////////////////////////////////////////////////////////////////////
         void CenturyVSPump::setup()
         {
+            this->stats_.window_start = millis();
+            std::fill(std::begin(this->last_codes_), std::end(this->last_codes_), -1);
+            build_frames_();
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            if (this->io_task_enabled_)
+            {
+                this->io_task_ = make_unique<CenturyPumpIoTask>(this, this->parent_, this->command_throttle_, this->response_timeout_);
+                if (this->io_task_->start())
+                {
+                    // The task reads the UART from now on
+                    this->parent_->disable_loop();
+                }
+                else
+                {
+                    ESP_LOGE(TAG, "Could not start the bus task, staying on the main loop");
+                    this->io_task_.reset();
+                }
+            }
+#endif
 #ifdef MODBUS_ENABLE_SWITCH
             enabled_switch_ = new CenturyPumpEnabledSwitch();
             enabled_switch_->set_name(name_ + " MODBUS enabled");
@@ -40,12 +191,19 @@ namespace esphome
         /////////////////////////////////////////////////////////////////////////////////////////////
         void CenturyVSPump::loop()
         {
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            if (this->io_task_ != nullptr)
+                collect_io_results_();
+#endif
             // Incoming data to process?
             if (!response_queue_.empty())
             {
                 auto &message = response_queue_.front();
                 if (message != nullptr)
+                {
                     process_modbus_data_(message.get());
+                    this->stats_.queued_bytes -= command_footprint_(*message);
+                }
                 response_queue_.pop();
             }
             else
@@ -66,8 +224,29 @@ namespace esphome
                 return;
 #endif
             ESP_LOGV(TAG, "Updating pump component");
-            for (auto item : items_)
-                queue_command_(item->create_command());
+            publish_diagnostics_();
+            if (this->diagnostics_window_ > 0 && millis() - this->stats_.window_start >= this->diagnostics_window_)
+                reset_diagnostics();
+
+            // While offline the backoff probe is the only traffic
+            if (this->link_state_ == LINK_OFFLINE)
+                return;
+
+            poll_registers_((this->update_count_++ % this->slow_poll_divider_) == 0);
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::poll_registers_(bool include_slow)
+        {
+            if (this->link_state_ == LINK_OFFLINE)
+                return;
+
+            for (size_t i = 0; i < this->register_count_; i++)
+            {
+                if (this->registers_[i].poll_class == POLL_SLOW && !include_slow)
+                    continue;
+                queue_command_(CenturyPumpCommand::create_register_read_command(this, i));
+            }
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -83,11 +262,16 @@ namespace esphome
             auto &current_command = this->command_queue_.front();
             if (current_command != nullptr)
             {
+                this->stats_.queued_bytes -= command_footprint_(*current_command);
                 current_command->payload_ = data;
+                this->stats_.queued_bytes += command_footprint_(*current_command);
                 this->response_queue_.push(std::move(current_command));
                 ESP_LOGV(TAG, "Pump response queued");
                 command_queue_.pop_front();
+                track_high_water_();
             }
+            on_reply_();
+            wake_();
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -104,8 +288,13 @@ namespace esphome
             if (current_command != nullptr)
             {
                 ESP_LOGD(TAG, "Modbus error (func=%02X, exc=%02X), removing command from queue", function_code, exception_code);
+                this->stats_.queued_bytes -= command_footprint_(*current_command);
+                this->stats_.dropped++;
                 command_queue_.pop_front();
             }
+            // An exception reply still proves the pump is reachable
+            on_reply_();
+            wake_();
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,10 +302,40 @@ namespace esphome
         {
             ESP_LOGCONFIG(TAG, "CenturyVSPump:");
             ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+            ESP_LOGCONFIG(TAG, "  Registers: %u (slow poll every %u updates)", (unsigned)this->register_count_, this->slow_poll_divider_);
+            for (size_t i = 0; i < this->register_count_; i++)
+            {
+                const CenturyPumpRegister &reg = this->registers_[i];
+                ESP_LOGCONFIG(TAG, "    [%u] func=%02X page=%d addr=%d width=%d scale=%d offset=%d%s", (unsigned)i, reg.function, reg.page,
+                              reg.address, reg.width, reg.scale, reg.offset, reg.poll_class == POLL_SLOW ? " slow" : "");
+            }
+            ESP_LOGCONFIG(TAG, "  Queues:");
+            ESP_LOGCONFIG(TAG, "    Command depth: %u (high water %u)", (unsigned)this->command_queue_.size(), this->stats_.command_high_water);
+            ESP_LOGCONFIG(TAG, "    Response depth: %u (high water %u)", (unsigned)this->response_queue_.size(), this->stats_.response_high_water);
+            ESP_LOGCONFIG(TAG, "    Enqueued: %" PRIu32 ", dropped: %" PRIu32, this->stats_.enqueued, this->stats_.dropped);
+            ESP_LOGCONFIG(TAG, "    Queued bytes: %" PRIu32 " (high water %" PRIu32 ")", this->stats_.queued_bytes, this->stats_.queued_bytes_high_water);
+            if (this->diagnostics_window_ > 0)
+                ESP_LOGCONFIG(TAG, "    Window: %" PRIu32 " ms", this->diagnostics_window_);
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            if (this->io_task_ != nullptr)
+                ESP_LOGCONFIG(TAG, "  Bus task: running (response timeout %" PRIu32 " ms)", this->response_timeout_);
+#endif
+#ifdef USE_TEXT_SENSOR
+            LOG_TEXT_SENSOR("  ", "Motor Status", this->code_text_sensors_[CODE_MOTOR_STATUS]);
+            LOG_TEXT_SENSOR("  ", "Prime Status", this->code_text_sensors_[CODE_PRIME_STATUS]);
+            LOG_TEXT_SENSOR("  ", "Previous Fault", this->code_text_sensors_[CODE_PREVIOUS_FAULT]);
+#endif
+            ESP_LOGCONFIG(TAG, "  Offline after %u failures, probe every %" PRIu32 "-%" PRIu32 " ms", this->offline_after_, this->probe_interval_,
+                          this->max_probe_interval_);
+#ifdef USE_BINARY_SENSOR
+            LOG_BINARY_SENSOR("  ", "Online", this->online_binary_sensor_);
+            LOG_BINARY_SENSOR("  ", "Running", this->running_binary_sensor_);
+            LOG_BINARY_SENSOR("  ", "Fault", this->fault_binary_sensor_);
+#endif
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
-        void CenturyVSPump::queue_command_(const CenturyPumpCommand &command)
+        void CenturyVSPump::queue_command_(const CenturyPumpCommand &command, CommandPriority priority)
         {
 #ifdef MODBUS_ENABLE_SWITCH
             if (enabled_switch_ == nullptr)
@@ -124,7 +343,184 @@ namespace esphome
             if (enabled_switch_->state == 0)
                 return;
 #endif
-            command_queue_.push_back(make_unique<CenturyPumpCommand>(command));
+            if (this->link_state_ == LINK_OFFLINE)
+            {
+                ESP_LOGW(TAG, "Pump offline, dropping command %02X", command.function_);
+                this->stats_.dropped++;
+                return;
+            }
+            enqueue_(command, priority);
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::enqueue_(const CenturyPumpCommand &command, CommandPriority priority)
+        {
+            auto entry = make_unique<CenturyPumpCommand>(command);
+            entry->priority_ = priority;
+            this->stats_.queued_bytes += command_footprint_(*entry);
+            this->stats_.enqueued++;
+            if (priority == PRIORITY_HIGH && !command_queue_.empty())
+            {
+                // Never ahead of the front command, it may already be awaiting a reply, nor of
+                // commands handed to the bus task. Behind any other high priority commands to keep them in order.
+                auto pos = std::next(command_queue_.begin(), std::max<size_t>(1, this->handed_off_));
+                while (pos != command_queue_.end() && (*pos)->priority_ == PRIORITY_HIGH)
+                    ++pos;
+                command_queue_.insert(pos, std::move(entry));
+            }
+            else
+            {
+                command_queue_.push_back(std::move(entry));
+            }
+            track_high_water_();
+            wake_();
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::flush_commands_()
+        {
+            // The in-flight command is flushed too; a late reply is then ignored as unsolicited.
+            // Commands handed to the bus task stay until it reports back on them, but it stops sending them.
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            if (this->io_task_ != nullptr)
+                this->io_task_->cancel_pending();
+#endif
+            auto first = std::next(this->command_queue_.begin(), this->handed_off_);
+            for (auto it = first; it != this->command_queue_.end(); ++it)
+            {
+                this->stats_.queued_bytes -= command_footprint_(**it);
+                this->stats_.dropped++;
+            }
+            this->command_queue_.erase(first, this->command_queue_.end());
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::on_reply_()
+        {
+            this->consecutive_failures_ = 0;
+            if (this->link_state_ == LINK_ONLINE)
+                return;
+
+            bool was_offline = this->link_state_ == LINK_OFFLINE;
+            this->link_state_ = LINK_ONLINE;
+            publish_link_state_();
+            if (was_offline)
+            {
+                ESP_LOGI(TAG, "Pump back online, resyncing");
+                this->cancel_timeout("probe");
+                poll_registers_(true);
+            }
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::on_no_reply_(bool probe)
+        {
+            if (this->link_state_ == LINK_OFFLINE)
+            {
+                // Commands that were already with the bus task when the pump went offline don't count
+                if (!probe)
+                    return;
+                // Probe went unanswered, back off
+                this->next_probe_interval_ = std::min(this->next_probe_interval_ * 2, this->max_probe_interval_);
+                schedule_probe_();
+                return;
+            }
+
+            if (++this->consecutive_failures_ < this->offline_after_)
+                return;
+
+            ESP_LOGW(TAG, "Pump not responding after %u unanswered commands, going offline", this->consecutive_failures_);
+            this->link_state_ = LINK_OFFLINE;
+            flush_commands_();
+            publish_link_state_();
+            this->next_probe_interval_ = this->probe_interval_;
+            schedule_probe_();
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::schedule_probe_()
+        {
+            ESP_LOGD(TAG, "Probing offline pump in %" PRIu32 " ms", this->next_probe_interval_);
+            this->set_timeout("probe", this->next_probe_interval_, [this]()
+                              { enqueue_(CenturyPumpCommand::create_probe_command(this)); });
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::publish_link_state_()
+        {
+#ifdef USE_BINARY_SENSOR
+            if (this->online_binary_sensor_ != nullptr)
+                this->online_binary_sensor_->publish_state(this->link_state_ == LINK_ONLINE);
+#endif
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::publish_code_(CodeTable table, uint16_t code)
+        {
+            if (table >= CODE_COUNT || this->last_codes_[table] == code)
+                return;
+            this->last_codes_[table] = code;
+
+#ifdef USE_TEXT_SENSOR
+            if (this->code_text_sensors_[table] != nullptr)
+                this->code_text_sensors_[table]->publish_state(describe_code(table, code));
+#endif
+#ifdef USE_BINARY_SENSOR
+            if (table == CODE_MOTOR_STATUS)
+            {
+                if (this->running_binary_sensor_ != nullptr)
+                    this->running_binary_sensor_->publish_state(code == 0x0B);
+                if (this->fault_binary_sensor_ != nullptr)
+                    this->fault_binary_sensor_->publish_state(code == 0x20);
+            }
+#endif
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::reset_diagnostics()
+        {
+            this->stats_.command_high_water = this->command_queue_.size();
+            this->stats_.response_high_water = this->response_queue_.size();
+            this->stats_.queued_bytes_high_water = this->stats_.queued_bytes;
+            this->stats_.window_start = millis();
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::track_high_water_()
+        {
+            if (this->command_queue_.size() > this->stats_.command_high_water)
+                this->stats_.command_high_water = this->command_queue_.size();
+            if (this->response_queue_.size() > this->stats_.response_high_water)
+                this->stats_.response_high_water = this->response_queue_.size();
+            if (this->stats_.queued_bytes > this->stats_.queued_bytes_high_water)
+                this->stats_.queued_bytes_high_water = this->stats_.queued_bytes;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        uint32_t CenturyVSPump::command_footprint_(const CenturyPumpCommand &command)
+        {
+            // Command object plus its payload buffer; ignores list node and std::function overhead
+            return sizeof(CenturyPumpCommand) + command.payload_.capacity();
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::publish_diagnostics_()
+        {
+            const float values[DIAG_COUNT] = {
+                (float)this->command_queue_.size(),
+                (float)this->stats_.command_high_water,
+                (float)this->response_queue_.size(),
+                (float)this->stats_.response_high_water,
+                (float)this->stats_.enqueued,
+                (float)this->stats_.dropped,
+                (float)this->stats_.queued_bytes,
+                (float)this->stats_.queued_bytes_high_water,
+            };
+            for (uint8_t i = 0; i < DIAG_COUNT; i++)
+            {
+                if (this->diagnostic_sensors_[i] != nullptr)
+                    this->diagnostic_sensors_[i]->publish_state(values[i]);
+            }
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -157,106 +553,313 @@ namespace esphome
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
-        bool CenturyVSPump::send_next_command_()
+        void CenturyVSPump::on_register_data_(size_t index, const std::vector<uint8_t> &data)
         {
-            uint32_t last_send = millis() - this->last_command_timestamp_;
-            if ((last_send > this->command_throttle_) && !waiting_for_response() && !command_queue_.empty())
+            const CenturyPumpRegister &reg = this->registers_[index];
+            switch (reg.function)
             {
-                auto &command = command_queue_.front();
+            case 0x43: // Pump status
+            {
+                if (!validate_response_size(data, 1, "Status"))
+                    return;
+
+                ESP_LOGD(TAG, "Got status command reply %02X", data[0]);
+                publish_code_(CODE_MOTOR_STATUS, data[0]);
 
-                if (command->send_countdown < 1)
+                bool running;
+                switch (data[0])
                 {
-                    ESP_LOGD(TAG, "Pump command %02X no response received - removed from send queue", command->function_);
-                    command_queue_.pop_front();
+                case 0x00: // Stopped
+                    running = false;
+                    break;
+                case 0x09: // Boot/Initializing
+                    ESP_LOGD(TAG, "Pump is booting/initializing");
+                    running = false;
+                    break;
+                case 0x0B: // Running
+                    running = true;
+                    break;
+                case 0x20: // Fault
+                    ESP_LOGW(TAG, "Pump reports FAULT condition");
+                    running = false;
+                    break;
+                default:
+                    ESP_LOGW(TAG, "Unknown pump status: 0x%02X", data[0]);
+                    return;
                 }
-                else
+                publish_register_(index, running ? 1.0f : 0.0f);
+                break;
+            }
+            case 0x45: // Read sensor
+            case 0x64: // Config read
+            {
+                uint16_t value;
+                if (!decode_read_reply(reg.function, reg.page, reg.address, reg.width, data, value))
+                    return;
+                if (reg.target == TARGET_CODE)
                 {
-                    ESP_LOGV(TAG, "Sending command with function %02X", command->function_);
-                    command->send();
-                    this->last_command_timestamp_ = millis();
+                    publish_code_((CodeTable)reg.code, value);
+                    return;
                 }
+                value /= reg.scale;
+                publish_register_(index, (float)value + reg.offset);
+                break;
+            }
+            default:
+                ESP_LOGW(TAG, "Register %u has unsupported function %02X", (unsigned)index, reg.function);
+                break;
             }
-            return true;
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
-        bool CenturyPumpCommand::send()
+        void CenturyVSPump::build_frames_()
         {
-            std::vector<uint8_t> cmd;
-            cmd.push_back(pump_->get_address());
-            cmd.push_back(function_);
-            cmd.push_back(0x20);
-            cmd.insert(cmd.end(), payload_.begin(), payload_.end());
-            pump_->send_raw(cmd);
-            this->send_countdown--;
-            return true;
+            // Poll requests never change, so encode them once. The modbus layer still appends the CRC.
+            this->frames_.resize(this->register_count_);
+            for (size_t i = 0; i < this->register_count_; i++)
+            {
+                const CenturyPumpRegister &reg = this->registers_[i];
+                auto &frame = this->frames_[i];
+                frame.reserve(6);
+                frame.push_back(this->address_);
+                frame.push_back(reg.function);
+                frame.push_back(0x20);
+                append_read_payload(frame, reg.function, reg.page, reg.address, reg.width);
+            }
+            this->probe_frame_ = {this->address_, 0x43, 0x20};
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
-        CenturyPumpCommand CenturyPumpCommand::create_status_command(CenturyVSPump *pump, std::function<void(CenturyVSPump *pump, bool running)> on_status_func)
+        void CenturyVSPump::publish_register_(size_t index, float value)
         {
-            CenturyPumpCommand cmd = {};
-            cmd.pump_ = pump;
-            cmd.function_ = 0x43; // Pump status
-            cmd.on_data_func_ = [=](CenturyVSPump *pump, const std::vector<uint8_t> data)
+            if (index >= this->targets_.size())
+                return;
+            EntityBase *target = this->targets_[index];
+            switch (this->registers_[index].target)
             {
-                if (!validate_response_size(data, 1, "Status"))
-                    return;
+#ifdef USE_SENSOR
+            case TARGET_SENSOR:
+                static_cast<sensor::Sensor *>(target)->publish_state(value);
+                break;
+#endif
+#ifdef USE_NUMBER
+            case TARGET_NUMBER:
+                static_cast<number::Number *>(target)->publish_state(value);
+                break;
+#endif
+#ifdef USE_SWITCH
+            case TARGET_SWITCH:
+                static_cast<switch_::Switch *>(target)->publish_state(value != 0.0f);
+                break;
+#endif
+            default:
+                break;
+            }
+        }
 
-                ESP_LOGD(TAG, "Got status command reply %02X", data[0]);
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        bool CenturyVSPump::send_next_command_()
+        {
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            if (this->io_task_ != nullptr)
+                return hand_off_commands_();
+#endif
+            if (command_queue_.empty())
+            {
+                // Nothing to do until enqueue_() or a reply wakes us up again
+                this->disable_loop();
+                return false;
+            }
+            if (waiting_for_response())
+            {
+                // The modbus layer does not report its own timeout, check back after one throttle period
+                this->sleep_for_(this->command_throttle_);
+                return false;
+            }
+            uint32_t last_send = millis() - this->last_command_timestamp_;
+            if (last_send <= this->command_throttle_)
+            {
+                this->sleep_for_(this->command_throttle_ - last_send + 1);
+                return false;
+            }
 
-                switch (data[0])
-                {
-                case 0x00: // Stopped
-                    on_status_func(pump, false);
+            auto &command = command_queue_.front();
+
+            if (command->send_countdown < 1)
+            {
+                drop_unanswered_();
+            }
+            else
+            {
+                ESP_LOGV(TAG, "Sending command with function %02X", command->function_);
+                command->send();
+                this->last_command_timestamp_ = millis();
+            }
+            return true;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::drop_unanswered_()
+        {
+            if (command_queue_.empty())
+                return;
+            auto &command = command_queue_.front();
+            ESP_LOGD(TAG, "Pump command %02X no response received - removed from send queue", command->function_);
+            this->stats_.queued_bytes -= command_footprint_(*command);
+            this->stats_.dropped++;
+            bool probe = command->probe_;
+            command_queue_.pop_front();
+            on_no_reply_(probe);
+        }
+
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        bool CenturyVSPump::hand_off_commands_()
+        {
+            bool handed = false;
+            auto it = std::next(command_queue_.begin(), this->handed_off_);
+            // Capped so finished transactions always fit in the result ring
+            while (it != command_queue_.end() && this->handed_off_ < CenturyPumpIoTask::RING_SIZE)
+            {
+                CenturyPumpIoRequest *request = this->io_task_->requests.acquire();
+                if (request == nullptr)
                     break;
-                case 0x09: // Boot/Initializing
-                    ESP_LOGD(TAG, "Pump is booting/initializing");
-                    on_status_func(pump, false);
+                auto &command = *it++;
+                // Pre-encoded frames live as long as the pump, only dynamic commands are copied into the slot
+                request->shared_frame = command->frame_;
+                if (command->frame_ == nullptr)
+                    command->encode(request->frame);
+                request->attempts = command->send_countdown;
+                request->generation = this->io_task_->generation();
+                command->send_countdown = 0; // retries are up to the task now
+                this->io_task_->requests.publish();
+                this->handed_off_++;
+                handed = true;
+            }
+            if (handed)
+                this->io_task_->notify();
+            // Woken by enqueue_() or by the task once a transaction finishes
+            this->disable_loop();
+            return handed;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::collect_io_results_()
+        {
+            // Results come back in hand-off order, so each one belongs to the front command
+            while (CenturyPumpIoResult *result = this->io_task_->results.front())
+            {
+                this->handed_off_--;
+                switch (result->status)
+                {
+                case IO_REPLY:
+                    on_modbus_data(result->data);
                     break;
-                case 0x0B: // Running
-                    on_status_func(pump, true);
+                case IO_EXCEPTION:
+                    on_modbus_error(result->function, result->exception);
                     break;
-                case 0x20: // Fault
-                    ESP_LOGW(TAG, "Pump reports FAULT condition");
-                    on_status_func(pump, false);
+                case IO_CANCELLED:
+                    if (!command_queue_.empty())
+                    {
+                        this->stats_.queued_bytes -= command_footprint_(*command_queue_.front());
+                        this->stats_.dropped++;
+                        command_queue_.pop_front();
+                    }
                     break;
                 default:
-                    ESP_LOGW(TAG, "Unknown pump status: 0x%02X", data[0]);
+                    drop_unanswered_();
                     break;
                 }
-            };
+                this->io_task_->results.pop();
+            }
+        }
+#endif
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::sleep_for_(uint32_t delay)
+        {
+            this->disable_loop();
+            this->set_timeout("wake", delay, [this]()
+                              { this->enable_loop(); });
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyVSPump::wake_()
+        {
+            this->cancel_timeout("wake");
+            this->enable_loop();
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        bool CenturyPumpCommand::send()
+        {
+            if (this->frame_ != nullptr)
+            {
+                pump_->send_raw(*this->frame_);
+                this->send_countdown--;
+                return true;
+            }
+
+            std::vector<uint8_t> cmd;
+            encode(cmd);
+            pump_->send_raw(cmd);
+            this->send_countdown--;
+            return true;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyPumpCommand::encode(std::vector<uint8_t> &frame) const
+        {
+            frame.clear();
+            frame.reserve(3 + payload_.size());
+            frame.push_back(pump_->get_address());
+            frame.push_back(function_);
+            frame.push_back(0x20);
+            frame.insert(frame.end(), payload_.begin(), payload_.end());
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        CenturyPumpCommand CenturyPumpCommand::create_register_read_command(CenturyVSPump *pump, size_t index)
+        {
+            const CenturyPumpRegister &reg = pump->get_register(index);
+            CenturyPumpCommand cmd = {};
+            cmd.pump_ = pump;
+            cmd.function_ = reg.function;
+            cmd.frame_ = pump->get_frame(index);
+            cmd.on_data_func_ = [index](CenturyVSPump *pump, const std::vector<uint8_t> &data)
+            { pump->on_register_data_(index, data); };
             return cmd;
         }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
-        CenturyPumpCommand CenturyPumpCommand::create_read_sensor_command(CenturyVSPump *pump, uint8_t page, uint8_t address, uint16_t scale, std::function<void(CenturyVSPump *pump, uint16_t value)> on_value_func)
+        CenturyPumpCommand CenturyPumpCommand::create_read_command(CenturyVSPump *pump, uint8_t function, uint8_t page, uint8_t address, uint8_t width, std::function<void(CenturyVSPump *pump, uint16_t value)> on_value_func)
         {
             CenturyPumpCommand cmd = {};
             cmd.pump_ = pump;
-            cmd.function_ = 0x45; // Read sensor
-            cmd.payload_.push_back(page);
-            cmd.payload_.push_back(address);
-            cmd.on_data_func_ = [=](CenturyVSPump *pump, const std::vector<uint8_t> data)
+            cmd.function_ = function;
+            append_read_payload(cmd.payload_, function, page, address, width);
+            cmd.on_data_func_ = [=](CenturyVSPump *pump, const std::vector<uint8_t> &data)
             {
-                // Response format: page, address, value (1-2 bytes)
-                if (!validate_response_size(data, 3, "Sensor read"))
-                    return;
-
-                uint16_t value = (uint16_t)data[2];
-                if (data.size() >= 4)
-                {
-                    // Two-byte sensor value (little-endian)
-                    value |= (uint16_t)data[3] << 8;
-                }
-                // Scale the value
-                value /= scale;
-                ESP_LOGD(TAG, "Read value %d from page %d, addr %d", value, page, address);
-                on_value_func(pump, value);
+                uint16_t value;
+                if (decode_read_reply(function, page, address, width, data, value))
+                    on_value_func(pump, value);
             };
             return cmd;
         }
 
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        CenturyPumpCommand CenturyPumpCommand::create_probe_command(CenturyVSPump *pump)
+        {
+            CenturyPumpCommand cmd = {};
+            cmd.pump_ = pump;
+            cmd.function_ = 0x43; // Pump status, only the reply itself matters
+            cmd.frame_ = pump->get_probe_frame();
+            cmd.send_countdown = 1;
+            cmd.probe_ = true;
+            cmd.on_data_func_ = [](CenturyVSPump *pump, const std::vector<uint8_t> &data) {};
+            return cmd;
+        }
+
         /////////////////////////////////////////////////////////////////////////////////////////////
         CenturyPumpCommand CenturyPumpCommand::create_run_command(CenturyVSPump *pump, std::function<void(CenturyVSPump *pump)> on_confirmation_func)
         {
@@ -303,36 +906,6 @@ namespace esphome
             return cmd;
         }
 
-        /////////////////////////////////////////////////////////////////////////////////////////////
-        CenturyPumpCommand CenturyPumpCommand::create_config_read_command(CenturyVSPump *pump, uint8_t page, uint8_t address, std::function<void(CenturyVSPump *pump, uint8_t value)> on_value_func)
-        {
-            CenturyPumpCommand cmd = {};
-            cmd.pump_ = pump;
-            cmd.function_ = 0x64; // Config Read/Write
-            cmd.payload_.push_back(page);     // Page (MSBit=0 for read)
-            cmd.payload_.push_back(address);
-            cmd.payload_.push_back(0);        // Length 0 = 1 byte
-            cmd.on_data_func_ = [=](CenturyVSPump *pump, const std::vector<uint8_t> data)
-            {
-                // Response format: page, address, length, data
-                if (!validate_response_size(data, 4, "Config read"))
-                    return;
-
-                // Validate response matches request (guards against line noise/corruption)
-                if (data[0] != page || data[1] != address)
-                {
-                    ESP_LOGW(TAG, "Config read response mismatch: expected page %d addr %d, got page %d addr %d",
-                             page, address, data[0], data[1]);
-                    return;
-                }
-
-                uint8_t value = data[3];
-                ESP_LOGD(TAG, "Config read page %d, addr %d = %d", page, address, value);
-                on_value_func(pump, value);
-            };
-            return cmd;
-        }
-
         /////////////////////////////////////////////////////////////////////////////////////////////
         CenturyPumpCommand CenturyPumpCommand::create_config_write_command(CenturyVSPump *pump, uint8_t page, uint8_t address, uint8_t value, std::function<void(CenturyVSPump *pump)> on_confirmation_func)
         {
@@ -365,36 +938,6 @@ namespace esphome
             return cmd;
         }
 
-        /////////////////////////////////////////////////////////////////////////////////////////////
-        CenturyPumpCommand CenturyPumpCommand::create_config_read_uint16_command(CenturyVSPump *pump, uint8_t page, uint8_t address, std::function<void(CenturyVSPump *pump, uint16_t value)> on_value_func)
-        {
-            CenturyPumpCommand cmd = {};
-            cmd.pump_ = pump;
-            cmd.function_ = 0x64; // Config Read/Write
-            cmd.payload_.push_back(page);     // Page (MSBit=0 for read)
-            cmd.payload_.push_back(address);
-            cmd.payload_.push_back(1);        // Length 1 = 2 bytes
-            cmd.on_data_func_ = [=](CenturyVSPump *pump, const std::vector<uint8_t> data)
-            {
-                // Response format: page, address, length, data_lo, data_hi
-                if (!validate_response_size(data, 5, "Config read uint16"))
-                    return;
-
-                // Validate response matches request (guards against line noise/corruption)
-                if (data[0] != page || data[1] != address)
-                {
-                    ESP_LOGW(TAG, "Config read uint16 response mismatch: expected page %d addr %d, got page %d addr %d",
-                             page, address, data[0], data[1]);
-                    return;
-                }
-
-                uint16_t value = (uint16_t)data[3] | ((uint16_t)data[4] << 8);
-                ESP_LOGD(TAG, "Config read uint16 page %d, addr %d = %d", page, address, value);
-                on_value_func(pump, value);
-            };
-            return cmd;
-        }
-
         /////////////////////////////////////////////////////////////////////////////////////////////
         CenturyPumpCommand CenturyPumpCommand::create_config_write_uint16_command(CenturyVSPump *pump, uint8_t page, uint8_t address, uint16_t value, std::function<void(CenturyVSPump *pump)> on_confirmation_func)
         {
@@ -2,13 +2,24 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
 
 #include "esphome/components/modbus/modbus.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/switch/switch.h"
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
 
 #include <queue>
 #include <list>
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+#include <atomic>
+#endif
 
 // #define MODBUS_ENABLE_SWITCH
 
@@ -31,6 +42,12 @@ namespace esphome
         class CenturyVSPump;
         class CenturyVSPumpSensor;
 
+        enum CommandPriority : uint8_t
+        {
+            PRIORITY_NORMAL, // behind everything already queued
+            PRIORITY_HIGH,   // ahead of queued normal commands
+        };
+
         /////////////////////////////////////////////////////////////////////////////////////////////////
         class CenturyPumpCommand
         {
@@ -39,36 +56,131 @@ namespace esphome
             CenturyVSPump *pump_{};
             uint8_t function_{};
             std::vector<uint8_t> payload_ = {};
+            // Pre-encoded request owned by the pump (address, function, 0x20, payload); payload_ is unused when set
+            const std::vector<uint8_t> *frame_{nullptr};
             std::function<void(CenturyVSPump *pump, const std::vector<uint8_t> &data)> on_data_func_;
             // limit the number of repeats
             uint8_t send_countdown{MAX_SEND_REPEATS};
+            CommandPriority priority_{PRIORITY_NORMAL};
+            // offline probe, only an unanswered probe backs off the probe interval
+            bool probe_{false};
 
             bool send();
+            /// writes the request frame (address, function, 0x20, payload) without the CRC, for commands without frame_
+            void encode(std::vector<uint8_t> &frame) const;
 
-            static CenturyPumpCommand create_status_command(CenturyVSPump *pump, std::function<void(CenturyVSPump *pump, bool running)> on_status_func);
-            static CenturyPumpCommand create_read_sensor_command(CenturyVSPump *pump, uint8_t page, uint8_t address, uint16_t scale, std::function<void(CenturyVSPump *pump, uint16_t value)> on_value_func);
+            static CenturyPumpCommand create_register_read_command(CenturyVSPump *pump, size_t index);
+            static CenturyPumpCommand create_read_command(CenturyVSPump *pump, uint8_t function, uint8_t page, uint8_t address, uint8_t width, std::function<void(CenturyVSPump *pump, uint16_t value)> on_value_func);
+            static CenturyPumpCommand create_probe_command(CenturyVSPump *pump);
             static CenturyPumpCommand create_run_command(CenturyVSPump *pump, std::function<void(CenturyVSPump *pump)> on_confirmation_func);
             static CenturyPumpCommand create_stop_command(CenturyVSPump *pump, std::function<void(CenturyVSPump *pump)> on_confirmation_func);
             static CenturyPumpCommand create_set_demand_command(CenturyVSPump *pump, uint16_t demand, std::function<void(CenturyVSPump *pump)> on_confirmation_func);
-            static CenturyPumpCommand create_config_read_command(CenturyVSPump *pump, uint8_t page, uint8_t address, std::function<void(CenturyVSPump *pump, uint8_t value)> on_value_func);
             static CenturyPumpCommand create_config_write_command(CenturyVSPump *pump, uint8_t page, uint8_t address, uint8_t value, std::function<void(CenturyVSPump *pump)> on_confirmation_func);
-            static CenturyPumpCommand create_config_read_uint16_command(CenturyVSPump *pump, uint8_t page, uint8_t address, std::function<void(CenturyVSPump *pump, uint16_t value)> on_value_func);
             static CenturyPumpCommand create_config_write_uint16_command(CenturyVSPump *pump, uint8_t page, uint8_t address, uint16_t value, std::function<void(CenturyVSPump *pump)> on_confirmation_func);
             static CenturyPumpCommand create_store_config_command(CenturyVSPump *pump, std::function<void(CenturyVSPump *pump)> on_confirmation_func);
         };
 
         /////////////////////////////////////////////////////////////////////////////////////////////////
-        class CenturyPumpItemBase
+        //
+        //  Register map
+        //
+        //  The code generator collects every entity attached to a pump and emits one constexpr table
+        //  of these descriptors per pump. Polling walks that table, so entities are just publish
+        //  targets rather than components with their own command factories.
+        //
+        enum RegisterTarget : uint8_t
         {
-        public:
-            CenturyPumpItemBase() : pump_(nullptr) {}
-            CenturyPumpItemBase(CenturyVSPump *pump) : pump_(pump) {}
-            virtual CenturyPumpCommand create_command() = 0;
+            TARGET_SENSOR,
+            TARGET_NUMBER,
+            TARGET_SWITCH,
+            TARGET_CODE, // decoded through a code table, see publish_code_()
+        };
 
+        /// status/fault code tables decoded natively into text and binary sensors
+        enum CodeTable : uint8_t
+        {
+            CODE_NONE,
+            CODE_MOTOR_STATUS,   // 0x43 status reply
+            CODE_PRIME_STATUS,   // sensor page 0, address 0x10
+            CODE_PREVIOUS_FAULT, // sensor page 0, address 0x09
+            CODE_COUNT,
+        };
+
+        enum PollClass : uint8_t
+        {
+            POLL_FAST, // every update
+            POLL_SLOW, // every slow_poll_divider updates
+        };
+
+        struct CenturyPumpRegister
+        {
+            uint8_t function; // 0x43 status, 0x45 read sensor, 0x64 config read
+            uint8_t page;
+            uint8_t address;
+            uint8_t width;  // value width in bytes
+            uint16_t scale; // raw value is divided by this
+            int16_t offset; // added after scaling
+            uint8_t poll_class;
+            uint8_t target;
+            uint8_t code; // CodeTable for TARGET_CODE rows
+        };
+
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        class CenturyPumpTargetBase
+        {
+        public:
             void set_pump(CenturyVSPump *pump) { pump_ = pump; }
+            void set_register(const CenturyPumpRegister *reg) { register_ = reg; }
 
         protected:
-            CenturyVSPump *pump_;
+            CenturyVSPump *pump_{nullptr};
+            const CenturyPumpRegister *register_{nullptr};
+        };
+
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        //
+        //  Queue diagnostics
+        //
+        //  Depth, high-water marks and heap held by queued commands, so long uptimes can be checked
+        //  for unbounded growth. High-water marks cover the current window, totals never reset.
+        //
+        enum DiagnosticSensor : uint8_t
+        {
+            DIAG_COMMAND_QUEUE_DEPTH,
+            DIAG_COMMAND_QUEUE_HIGH_WATER,
+            DIAG_RESPONSE_QUEUE_DEPTH,
+            DIAG_RESPONSE_QUEUE_HIGH_WATER,
+            DIAG_COMMANDS_ENQUEUED,
+            DIAG_COMMANDS_DROPPED,
+            DIAG_QUEUED_BYTES,
+            DIAG_QUEUED_BYTES_HIGH_WATER,
+            DIAG_COUNT,
+        };
+
+        struct CenturyPumpQueueStats
+        {
+            uint32_t enqueued{0};
+            uint32_t dropped{0};
+            uint32_t queued_bytes{0};
+            uint32_t queued_bytes_high_water{0};
+            uint16_t command_high_water{0};
+            uint16_t response_high_water{0};
+            uint32_t window_start{0};
+        };
+
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        //
+        //  Link state
+        //
+        //  After offline_after consecutive commands go unanswered the pump is considered offline:
+        //  the queue is flushed and only a single status probe is sent, backing off exponentially
+        //  up to max_probe_interval. The first reply of any kind brings it back online.
+        //
+        enum LinkState : uint8_t
+        {
+            LINK_UNKNOWN,
+            LINK_ONLINE,
+            LINK_OFFLINE,
         };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -87,6 +199,112 @@ namespace esphome
         };
 #endif
 
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        //
+        //  Dedicated bus task
+        //
+        //  With io_task enabled, frame TX/RX, retries and response timeouts run in their own task
+        //  (pinned to the other core on dual core ESP32s, a std::thread on host builds) so Wi-Fi and
+        //  API work on the main loop no longer stretches bus turnaround. The task owns the modbus
+        //  UART, whose own loop is disabled, so the pump must be the only device on that bus.
+        //
+        //  Commands go out and results come back through single producer/single consumer rings.
+        //  Slots are reused in place, so once their vectors have grown nothing is allocated.
+        //
+        template <typename T, size_t N>
+        class SpscRing
+        {
+            static_assert((N & (N - 1)) == 0, "ring size must be a power of two");
+
+        public:
+            /// producer: free slot to fill in, nullptr when full
+            T *acquire()
+            {
+                size_t head = head_.load(std::memory_order_relaxed);
+                if (head - tail_.load(std::memory_order_acquire) == N)
+                    return nullptr;
+                return &slots_[head & (N - 1)];
+            }
+            /// producer: hands the acquired slot to the consumer
+            void publish() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+            /// consumer: oldest published slot, nullptr when empty
+            T *front()
+            {
+                size_t tail = tail_.load(std::memory_order_relaxed);
+                if (head_.load(std::memory_order_acquire) == tail)
+                    return nullptr;
+                return &slots_[tail & (N - 1)];
+            }
+            /// consumer: returns the front slot to the producer
+            void pop() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        private:
+            T slots_[N];
+            std::atomic<size_t> head_{0};
+            std::atomic<size_t> tail_{0};
+        };
+
+        struct CenturyPumpIoRequest
+        {
+            const std::vector<uint8_t> *shared_frame{nullptr}; // pre-encoded frame owned by the pump
+            std::vector<uint8_t> frame;                       // dynamic commands only, without CRC
+            uint8_t attempts;
+            uint32_t generation; // skipped once the main loop has moved past it
+        };
+
+        enum CenturyPumpIoStatus : uint8_t
+        {
+            IO_REPLY,
+            IO_EXCEPTION,
+            IO_NO_REPLY,  // every attempt timed out
+            IO_CANCELLED, // flushed before it was sent
+        };
+
+        struct CenturyPumpIoResult
+        {
+            CenturyPumpIoStatus status;
+            uint8_t function;
+            uint8_t exception;
+            std::vector<uint8_t> data; // as passed to on_modbus_data(): function, ACK, payload
+        };
+
+        class CenturyPumpIoTask
+        {
+        public:
+            static const size_t RING_SIZE = 4; // commands in flight at once
+            static const size_t MAX_FRAME = 64;
+
+            CenturyPumpIoTask(CenturyVSPump *pump, Modbus *bus, uint16_t throttle, uint32_t response_timeout);
+            bool start();
+            /// main loop: call after publishing requests
+            void notify();
+            uint32_t generation() const { return generation_.load(std::memory_order_relaxed); }
+            /// main loop: requests handed off so far come back as IO_CANCELLED instead of being sent
+            void cancel_pending() { generation_.fetch_add(1, std::memory_order_relaxed); }
+
+            SpscRing<CenturyPumpIoRequest, RING_SIZE> requests;
+            SpscRing<CenturyPumpIoResult, RING_SIZE> results;
+
+        protected:
+            static void task_entry_(void *arg);
+            void run_();
+            void wait_for_request_();
+            void transact_(const CenturyPumpIoRequest &request, CenturyPumpIoResult &result);
+            /// true once rx_ holds a complete reply or exception from our pump
+            bool parse_reply_(CenturyPumpIoResult &result);
+
+            CenturyVSPump *pump_;
+            Modbus *bus_;
+            uint16_t throttle_;
+            uint32_t response_timeout_;
+            uint32_t last_transaction_{0};
+            std::atomic<uint32_t> generation_{0};
+            std::vector<uint8_t> rx_;
+            void *handle_{nullptr};
+        };
+#endif
+
         /////////////////////////////////////////////////////////////////////////////////////////////////
         //
         //  To work successfully, this component needs modification to the ESPHome modbus.cpp file which
@@ -110,23 +328,117 @@ namespace esphome
             void on_modbus_data(const std::vector<uint8_t> &data) override;
             /// called when a modbus error response was received
             void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
-            /// Registers an item with the controller. Called by esphomes code generator
-            void add_item(CenturyPumpItemBase *item) { items_.push_back(item); }
-            void queue_command_(const CenturyPumpCommand &cmd);
+            /// Sets the register table emitted by esphomes code generator
+            void set_registers(const CenturyPumpRegister *registers, size_t count)
+            {
+                registers_ = registers;
+                register_count_ = count;
+            }
+            /// Registers the entity that publishes register `targets_.size()`. Called by esphomes code generator
+            void add_target(EntityBase *target) { targets_.push_back(target); }
+            void set_slow_poll_divider(uint8_t divider) { slow_poll_divider_ = divider; }
+            const CenturyPumpRegister &get_register(size_t index) const { return registers_[index]; }
+            /// pre-encoded poll request for a register, nullptr before setup()
+            const std::vector<uint8_t> *get_frame(size_t index) const { return index < frames_.size() ? &frames_[index] : nullptr; }
+            const std::vector<uint8_t> *get_probe_frame() const { return probe_frame_.empty() ? nullptr : &probe_frame_; }
+            void set_diagnostic_sensor(DiagnosticSensor type, sensor::Sensor *sens) { diagnostic_sensors_[type] = sens; }
+            void set_diagnostics_window(uint32_t window) { diagnostics_window_ = window; }
+            const CenturyPumpQueueStats &get_queue_stats() const { return stats_; }
+            /// starts a new diagnostics window, clearing the high-water marks
+            void reset_diagnostics();
+            void set_offline_after(uint8_t failures) { offline_after_ = failures; }
+            void set_probe_interval(uint32_t interval) { probe_interval_ = interval; }
+            void set_max_probe_interval(uint32_t interval) { max_probe_interval_ = interval; }
+            bool is_online() const { return link_state_ != LINK_OFFLINE; }
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            void set_io_task(bool enabled) { io_task_enabled_ = enabled; }
+            void set_response_timeout(uint32_t timeout) { response_timeout_ = timeout; }
+#endif
+#ifdef USE_BINARY_SENSOR
+            void set_online_binary_sensor(binary_sensor::BinarySensor *sens) { online_binary_sensor_ = sens; }
+            void set_running_binary_sensor(binary_sensor::BinarySensor *sens) { running_binary_sensor_ = sens; }
+            void set_fault_binary_sensor(binary_sensor::BinarySensor *sens) { fault_binary_sensor_ = sens; }
+#endif
+#ifdef USE_TEXT_SENSOR
+            void set_code_text_sensor(CodeTable table, text_sensor::TextSensor *sens) { code_text_sensors_[table] = sens; }
+#endif
+            void queue_command_(const CenturyPumpCommand &cmd, CommandPriority priority = PRIORITY_NORMAL);
+            /// queues a read of every fast register, and of the slow ones when include_slow is set
+            void poll_registers_(bool include_slow);
+            /// decodes a reply to a register table poll and publishes it to the owning entity
+            void on_register_data_(size_t index, const std::vector<uint8_t> &data);
 
         protected:
             void process_modbus_data_(const CenturyPumpCommand *response);
             bool send_next_command_();
+            /// pops the front command after its last attempt went unanswered
+            void drop_unanswered_();
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            /// hands queued commands to the bus task while it has room
+            bool hand_off_commands_();
+            /// applies finished bus task transactions to the front of the queue
+            void collect_io_results_();
+#endif
+            void publish_register_(size_t index, float value);
+            void build_frames_();
+            void publish_diagnostics_();
+            void track_high_water_();
+            /// approximate heap held by a queued command
+            static uint32_t command_footprint_(const CenturyPumpCommand &command);
+            void enqueue_(const CenturyPumpCommand &command, CommandPriority priority = PRIORITY_NORMAL);
+            void flush_commands_();
+            void on_reply_();
+            void on_no_reply_(bool probe);
+            void schedule_probe_();
+            void publish_link_state_();
+            /// publishes a status/fault code to its text and binary sensors, only when it changes
+            void publish_code_(CodeTable table, uint16_t code);
+            /// disables loop() until the given delay has passed
+            void sleep_for_(uint32_t delay);
+            /// re-enables loop() right away, dropping any pending sleep
+            void wake_();
 
         private:
             std::list<std::unique_ptr<CenturyPumpCommand>> command_queue_;
             std::queue<std::unique_ptr<CenturyPumpCommand>> response_queue_;
             uint32_t last_command_timestamp_{0};
             uint16_t command_throttle_{10};
+            // commands at the front of command_queue_ owned by the bus task
+            size_t handed_off_{0};
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+            bool io_task_enabled_{false};
+            uint32_t response_timeout_{250};
+            std::unique_ptr<CenturyPumpIoTask> io_task_;
+#endif
+            const CenturyPumpRegister *registers_{nullptr};
+            size_t register_count_{0};
+            std::vector<EntityBase *> targets_;
+            std::vector<std::vector<uint8_t>> frames_;
+            std::vector<uint8_t> probe_frame_;
+            uint8_t slow_poll_divider_{6};
+            uint32_t update_count_{0};
+            CenturyPumpQueueStats stats_;
+            uint32_t diagnostics_window_{0};
+            sensor::Sensor *diagnostic_sensors_[DIAG_COUNT]{};
+            LinkState link_state_{LINK_UNKNOWN};
+            uint8_t offline_after_{3};
+            uint8_t consecutive_failures_{0};
+            uint32_t probe_interval_{10000};
+            uint32_t max_probe_interval_{300000};
+            uint32_t next_probe_interval_{0};
+            // last published code per table, -1 until the first publish (filled in setup())
+            int32_t last_codes_[CODE_COUNT]{};
+#ifdef USE_BINARY_SENSOR
+            binary_sensor::BinarySensor *online_binary_sensor_{nullptr};
+            binary_sensor::BinarySensor *running_binary_sensor_{nullptr};
+            binary_sensor::BinarySensor *fault_binary_sensor_{nullptr};
+#endif
+#ifdef USE_TEXT_SENSOR
+            text_sensor::TextSensor *code_text_sensors_[CODE_COUNT]{};
+#endif
 
         public:
             std::string name_;
-            std::vector<CenturyPumpItemBase *> items_;
 #ifdef MODBUS_ENABLE_SWITCH
             CenturyPumpEnabledSwitch *enabled_switch_{nullptr};
 #endif
@@ -0,0 +1,180 @@
+#include "CenturyVSPump.h"
+
+#ifdef USE_CENTURYVSPUMP_IO_TASK
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+namespace esphome
+{
+    namespace century_vs_pump
+    {
+        static const char *const TAG = "century_vs_pump.io";
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        CenturyPumpIoTask::CenturyPumpIoTask(CenturyVSPump *pump, Modbus *bus, uint16_t throttle, uint32_t response_timeout)
+            : pump_(pump), bus_(bus), throttle_(throttle), response_timeout_(response_timeout)
+        {
+            rx_.reserve(MAX_FRAME);
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        bool CenturyPumpIoTask::start()
+        {
+#ifdef USE_ESP32
+            TaskHandle_t handle = nullptr;
+#ifdef CONFIG_FREERTOS_UNICORE
+            BaseType_t created = xTaskCreate(task_entry_, "centuryvspump", 4096, this, 5, &handle);
+#else
+            // The main loop runs on core 1, keep the bus on core 0
+            BaseType_t created = xTaskCreatePinnedToCore(task_entry_, "centuryvspump", 4096, this, 5, &handle, 0);
+#endif
+            this->handle_ = handle;
+            return created == pdPASS;
+#else
+            std::thread(task_entry_, this).detach();
+            return true;
+#endif
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyPumpIoTask::notify()
+        {
+#ifdef USE_ESP32
+            if (this->handle_ != nullptr)
+                xTaskNotifyGive(static_cast<TaskHandle_t>(this->handle_));
+#endif
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyPumpIoTask::wait_for_request_()
+        {
+#ifdef USE_ESP32
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+#else
+            delay(1);
+#endif
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyPumpIoTask::task_entry_(void *arg)
+        {
+            static_cast<CenturyPumpIoTask *>(arg)->run_();
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyPumpIoTask::run_()
+        {
+            for (;;)
+            {
+                CenturyPumpIoRequest *request = this->requests.front();
+                if (request == nullptr)
+                {
+                    wait_for_request_();
+                    continue;
+                }
+                CenturyPumpIoResult *result = this->results.acquire();
+                if (result == nullptr)
+                {
+                    // Cannot happen while the main loop caps hand-offs at RING_SIZE
+                    delay(1);
+                    continue;
+                }
+                transact_(*request, *result);
+                this->requests.pop();
+                this->results.publish();
+                this->pump_->enable_loop_soon_any_context();
+            }
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        void CenturyPumpIoTask::transact_(const CenturyPumpIoRequest &request, CenturyPumpIoResult &result)
+        {
+            const std::vector<uint8_t> &frame = request.shared_frame != nullptr ? *request.shared_frame : request.frame;
+            result.function = frame[1];
+            for (uint8_t attempt = 1; attempt <= request.attempts; attempt++)
+            {
+                uint32_t idle = millis() - this->last_transaction_;
+                if (idle < this->throttle_)
+                    delay(this->throttle_ - idle);
+                if (request.generation != this->generation())
+                {
+                    result.status = IO_CANCELLED;
+                    return;
+                }
+
+                // Anything still on the line belongs to an earlier, abandoned request
+                uint8_t byte;
+                while (this->bus_->available() > 0)
+                    this->bus_->read_byte(&byte);
+                this->rx_.clear();
+
+                this->bus_->send_raw(frame);
+                uint32_t sent = millis();
+                bool complete = false;
+                while (!complete && millis() - sent < this->response_timeout_)
+                {
+                    if (this->bus_->available() <= 0)
+                    {
+                        delay(1);
+                        continue;
+                    }
+                    this->bus_->read_byte(&byte);
+                    if (this->rx_.size() >= MAX_FRAME)
+                        this->rx_.clear();
+                    this->rx_.push_back(byte);
+                    complete = parse_reply_(result);
+                }
+                this->last_transaction_ = millis();
+                if (complete)
+                    return;
+                ESP_LOGV(TAG, "No reply to %02X, attempt %u of %u", result.function, attempt, request.attempts);
+            }
+            result.status = IO_NO_REPLY;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        bool CenturyPumpIoTask::parse_reply_(CenturyPumpIoResult &result)
+        {
+            size_t size = this->rx_.size();
+            if (this->rx_[0] != this->pump_->get_address())
+            {
+                // Resync on the next byte
+                this->rx_.erase(this->rx_.begin());
+                return false;
+            }
+            if (size < 4)
+                return false;
+
+            uint8_t function = this->rx_[1];
+            if (function & 0x80)
+            {
+                // Exception: address, function | 0x80, exception code, CRC
+                if (size < 5 || crc16(this->rx_.data(), 3) != (uint16_t(this->rx_[3]) | (uint16_t(this->rx_[4]) << 8)))
+                    return false;
+                result.status = IO_EXCEPTION;
+                result.function = function & 0x7F;
+                result.exception = this->rx_[2];
+                return true;
+            }
+
+            // User defined functions carry no length, the frame ends where the CRC matches
+            uint16_t remote_crc = uint16_t(this->rx_[size - 2]) | (uint16_t(this->rx_[size - 1]) << 8);
+            if (crc16(this->rx_.data(), size - 2) != remote_crc)
+                return false;
+            result.status = IO_REPLY;
+            result.data.assign(this->rx_.begin() + 1, this->rx_.end() - 2);
+            return true;
+        }
+    }
+}
+
+#endif
@@ -1,11 +1,30 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome import automation
 from esphome.components import modbus
 
-from esphome.const import CONF_ADDRESS, CONF_ID
+from esphome.const import CONF_ADDRESS, CONF_ID, CONF_TRIGGER_ID, CONF_TYPE, CONF_VALUE
+from esphome.core import CORE, Lambda, coroutine_with_priority
 from esphome.cpp_helpers import logging
 
-from .const import CONF_CENTURY_VS_PUMP_ID
+from .const import (
+    CONF_CENTURY_VS_PUMP_ID,
+    CONF_DIAGNOSTICS_WINDOW,
+    CONF_IO_TASK,
+    CONF_MAX_PROBE_INTERVAL,
+    CONF_MODBUS_ID,
+    CONF_OFFLINE_AFTER,
+    CONF_ON_RESPONSE,
+    CONF_PAGE,
+    CONF_POLL_CLASS,
+    CONF_PRIORITY,
+    CONF_PROBE_INTERVAL,
+    CONF_RESPONSE_TIMEOUT,
+    CONF_STORE_TO_FLASH,
+    CONF_WIDTH,
+    CONF_SLOW_POLL_DIVIDER,
+)
 
 CODEOWNERS = ["@gazoodle"]
 
@@ -13,37 +32,340 @@ AUTO_LOAD = ["modbus"]
 
 MULTI_CONF = True
 
+DOMAIN = "centuryvspump"
+
 # pylint: disable=invalid-name
 century_vs_pump_ns = cg.esphome_ns.namespace("century_vs_pump")
 CenturyVSPump = century_vs_pump_ns.class_(
     "CenturyVSPump", cg.PollingComponent, modbus.ModbusDevice
 )
 
+ReadRegisterAction = century_vs_pump_ns.class_("ReadRegisterAction", automation.Action)
+WriteRegisterAction = century_vs_pump_ns.class_(
+    "WriteRegisterAction", automation.Action
+)
+CommandPriority = century_vs_pump_ns.enum("CommandPriority")
+
 _LOGGER = logging.getLogger(__name__)
 
+# Register function codes the pump can poll from its table
+FUNCTION_STATUS = 0x43
+FUNCTION_READ_SENSOR = 0x45
+FUNCTION_CONFIG = 0x64
+
+TARGET_SENSOR = "TARGET_SENSOR"
+TARGET_NUMBER = "TARGET_NUMBER"
+TARGET_SWITCH = "TARGET_SWITCH"
+
+POLL_CLASSES = {"fast": "POLL_FAST", "slow": "POLL_SLOW"}
+
+COMMAND_PRIORITIES = {
+    "normal": CommandPriority.PRIORITY_NORMAL,
+    "high": CommandPriority.PRIORITY_HIGH,
+}
+
+CODE_MOTOR_STATUS = "CODE_MOTOR_STATUS"
+CODE_PRIME_STATUS = "CODE_PRIME_STATUS"
+CODE_PREVIOUS_FAULT = "CODE_PREVIOUS_FAULT"
+
+# Register each code table is polled from: function, page, address
+CODE_REGISTERS = {
+    CODE_MOTOR_STATUS: (FUNCTION_STATUS, 0, 0),
+    CODE_PRIME_STATUS: (FUNCTION_READ_SENSOR, 0, 0x10),
+    CODE_PREVIOUS_FAULT: (FUNCTION_READ_SENSOR, 0, 0x09),
+}
+
+READ_FUNCTIONS = {"sensor": FUNCTION_READ_SENSOR, "config": FUNCTION_CONFIG}
+
+
+def _validate_io_task(config):
+    if config[CONF_IO_TASK] and not (CORE.is_esp32 or CORE.is_host):
+        raise cv.Invalid(f"{CONF_IO_TASK} is only available on ESP32 and host")
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(CenturyVSPump),
+            cv.Optional(CONF_SLOW_POLL_DIVIDER, default=6): cv.int_range(
+                min=1, max=255
+            ),
+            cv.Optional(
+                CONF_DIAGNOSTICS_WINDOW
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_OFFLINE_AFTER, default=3): cv.int_range(min=1, max=255),
+            cv.Optional(
+                CONF_PROBE_INTERVAL, default="10s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_MAX_PROBE_INTERVAL, default="5min"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_IO_TASK, default=False): cv.boolean,
+            cv.Optional(
+                CONF_RESPONSE_TIMEOUT, default="250ms"
+            ): cv.positive_time_period_milliseconds,
         }
     )
     .extend(cv.polling_component_schema("10s"))
-    .extend(modbus.modbus_device_schema(21))
+    .extend(modbus.modbus_device_schema(21)),
+    _validate_io_task,
 )
 
+
+def _modbus_devices(node, found):
+    if isinstance(node, dict):
+        if CONF_MODBUS_ID in node:
+            found.append(node)
+        for value in node.values():
+            _modbus_devices(value, found)
+    elif isinstance(node, list):
+        for value in node:
+            _modbus_devices(value, found)
+    return found
+
+
+def _final_validate_io_task(config):
+    # The bus task owns the modbus UART and disables the modbus loop, nothing else can share it
+    if not config[CONF_IO_TASK]:
+        return config
+    bus = config[CONF_MODBUS_ID].id
+    for device in _modbus_devices(fv.full_config.get(), []):
+        if device[CONF_MODBUS_ID].id == bus and device.get(CONF_ID) != config[CONF_ID]:
+            raise cv.Invalid(
+                f"{CONF_IO_TASK} needs modbus '{bus}' to itself, but '{device.get(CONF_ID)}' also uses it",
+                path=[CONF_IO_TASK],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate_io_task
+
+
 CenturyVSPumpItemSchema = cv.Schema(
     {
         cv.GenerateID(CONF_CENTURY_VS_PUMP_ID): cv.use_id(CenturyVSPump),
+        cv.Optional(CONF_POLL_CLASS, default="fast"): cv.one_of(
+            *POLL_CLASSES, lower=True
+        ),
     }
 )
 
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
+    cg.add(var.set_slow_poll_divider(config[CONF_SLOW_POLL_DIVIDER]))
+    if CONF_DIAGNOSTICS_WINDOW in config:
+        cg.add(var.set_diagnostics_window(config[CONF_DIAGNOSTICS_WINDOW]))
+    cg.add(var.set_offline_after(config[CONF_OFFLINE_AFTER]))
+    cg.add(var.set_probe_interval(config[CONF_PROBE_INTERVAL]))
+    cg.add(var.set_max_probe_interval(config[CONF_MAX_PROBE_INTERVAL]))
+    if config[CONF_IO_TASK]:
+        cg.add_define("USE_CENTURYVSPUMP_IO_TASK")
+        cg.add(var.set_io_task(True))
+        cg.add(var.set_response_timeout(config[CONF_RESPONSE_TIMEOUT]))
+        if CORE.is_host:
+            cg.add_build_flag("-pthread")
     await register_centuryvspump_device(var, config)
+    CORE.add_job(_emit_register_table, var, config[CONF_ID])
 
 
 async def register_centuryvspump_device(var, config):
     cg.add(var.set_address(config[CONF_ADDRESS]))
     await cg.register_component(var, config)
     return await modbus.register_modbus_device(var, config)
+
+
+def _pump_items(config):
+    return CORE.data.setdefault(DOMAIN, {}).setdefault(
+        config[CONF_CENTURY_VS_PUMP_ID].id, {"items": [], "codes": {}}
+    )
+
+
+async def register_centuryvspump_item(
+    var, config, target, function, page=0, address=0, width=1, scale=1, offset=0
+):
+    """Attach an entity to its pump and queue its row for the pump's register table."""
+    paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
+    cg.add(var.set_pump(paren))
+    _pump_items(config)["items"].append(
+        {
+            "var": var,
+            "function": function,
+            "page": page,
+            "address": address,
+            "width": width,
+            "scale": scale,
+            "offset": offset,
+            "poll_class": config[CONF_POLL_CLASS],
+            "target": target,
+            "code": "CODE_NONE",
+        }
+    )
+
+
+def register_centuryvspump_code(config, code):
+    """Request polling of a status/fault code table; shared by every entity decoding it."""
+    codes = _pump_items(config)["codes"]
+    # The fastest poll class requested wins
+    if codes.get(code) != "fast":
+        codes[code] = config[CONF_POLL_CLASS]
+
+
+def _code_rows(pump):
+    status_polls = {
+        i["poll_class"] for i in pump["items"] if i["function"] == FUNCTION_STATUS
+    }
+    rows = []
+    for code, poll_class in pump["codes"].items():
+        function, page, address = CODE_REGISTERS[code]
+        # Every status poll already feeds the motor status code
+        if function == FUNCTION_STATUS and status_polls & {"fast", poll_class}:
+            continue
+        rows.append(
+            {
+                "var": None,
+                "function": function,
+                "page": page,
+                "address": address,
+                "width": 2,
+                "scale": 1,
+                "offset": 0,
+                "poll_class": poll_class,
+                "target": "TARGET_CODE",
+                "code": code,
+            }
+        )
+    return rows
+
+
+# Runs after every platform has added its items, so the table is complete
+@coroutine_with_priority(-100.0)
+async def _emit_register_table(var, pump_id):
+    pump = CORE.data.get(DOMAIN, {}).get(pump_id.id)
+    if pump is None:
+        return
+    items = pump["items"] + _code_rows(pump)
+    if not items:
+        return
+
+    table = f"{pump_id.id}_registers"
+    rows = ",\n".join(
+        f"    {{0x{i['function']:02X}, {i['page']}, {i['address']}, {i['width']}, "
+        f"{i['scale']}, {i['offset']}, "
+        f"century_vs_pump::{POLL_CLASSES[i['poll_class']]}, "
+        f"century_vs_pump::{i['target']}, century_vs_pump::{i['code']}}}"
+        for i in items
+    )
+    cg.add_global(
+        cg.RawStatement(
+            f"static constexpr century_vs_pump::CenturyPumpRegister {table}[] = {{\n{rows}\n}};"
+        )
+    )
+    cg.add(var.set_registers(cg.RawExpression(table), len(items)))
+    for index, item in enumerate(items):
+        if item["var"] is None:
+            cg.add(var.add_target(cg.nullptr))
+            continue
+        cg.add(var.add_target(item["var"]))
+        cg.add(item["var"].set_register(cg.RawExpression(f"&{table}[{index}]")))
+
+
+REGISTER_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(CenturyVSPump),
+        cv.Required(CONF_PAGE): cv.templatable(cv.uint8_t),
+        cv.Required(CONF_ADDRESS): cv.templatable(cv.uint8_t),
+        cv.Optional(CONF_WIDTH, default=1): cv.int_range(min=1, max=2),
+        cv.Optional(CONF_PRIORITY, default="normal"): cv.enum(
+            COMMAND_PRIORITIES, lower=True
+        ),
+    }
+)
+
+
+@automation.register_action(
+    "centuryvspump.read_register",
+    ReadRegisterAction,
+    REGISTER_ACTION_SCHEMA.extend(
+        {
+            cv.Optional(CONF_TYPE, default="sensor"): cv.one_of(
+                *READ_FUNCTIONS, lower=True
+            ),
+            cv.Optional(CONF_ON_RESPONSE): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
+                        automation.Trigger.template(cg.uint16)
+                    ),
+                },
+                single=True,
+            ),
+        }
+    ),
+)
+async def read_register_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    await _set_register_action_common(var, config, args)
+    cg.add(var.set_function(READ_FUNCTIONS[config[CONF_TYPE]]))
+    if CONF_ON_RESPONSE in config:
+        conf = config[CONF_ON_RESPONSE]
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID])
+        cg.add(var.set_response_trigger(trigger))
+        await automation.build_automation(trigger, [(cg.uint16, "value")], conf)
+    return var
+
+
+def _validate_write_value(config):
+    value = config[CONF_VALUE]
+    if not isinstance(value, Lambda) and config[CONF_WIDTH] == 1 and value > 0xFF:
+        raise cv.Invalid(
+            f"{CONF_VALUE} {value} does not fit a 1 byte register, set {CONF_WIDTH}: 2",
+            path=[CONF_VALUE],
+        )
+    return config
+
+
+@automation.register_action(
+    "centuryvspump.write_register",
+    WriteRegisterAction,
+    cv.All(
+        REGISTER_ACTION_SCHEMA.extend(
+            {
+                cv.Required(CONF_VALUE): cv.templatable(cv.uint16_t),
+                cv.Optional(CONF_STORE_TO_FLASH, default=False): cv.boolean,
+                cv.Optional(CONF_ON_RESPONSE): automation.validate_automation(
+                    {
+                        cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
+                            automation.Trigger.template()
+                        ),
+                    },
+                    single=True,
+                ),
+            }
+        ),
+        _validate_write_value,
+    ),
+)
+async def write_register_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    await _set_register_action_common(var, config, args)
+    template_ = await cg.templatable(config[CONF_VALUE], args, cg.uint16)
+    cg.add(var.set_value(template_))
+    cg.add(var.set_store_to_flash(config[CONF_STORE_TO_FLASH]))
+    if CONF_ON_RESPONSE in config:
+        conf = config[CONF_ON_RESPONSE]
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID])
+        cg.add(var.set_response_trigger(trigger))
+        await automation.build_automation(trigger, [], conf)
+    return var
+
+
+async def _set_register_action_common(var, config, args):
+    template_ = await cg.templatable(config[CONF_PAGE], args, cg.uint8)
+    cg.add(var.set_page(template_))
+    template_ = await cg.templatable(config[CONF_ADDRESS], args, cg.uint8)
+    cg.add(var.set_address(template_))
+    cg.add(var.set_width(config[CONF_WIDTH]))
+    cg.add(var.set_priority(config[CONF_PRIORITY]))
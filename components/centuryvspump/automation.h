@@ -0,0 +1,96 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/log.h"
+#include "CenturyVSPump.h"
+
+namespace esphome
+{
+    namespace century_vs_pump
+    {
+        static const char *const TAG = "century_vs_pump.action";
+
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        //
+        //  On-demand register access for automations, so rarely needed registers don't have to be
+        //  permanent entities in the poll cycle
+        //
+        template <typename... Ts>
+        class ReadRegisterAction : public Action<Ts...>, public Parented<CenturyVSPump>
+        {
+        public:
+            TEMPLATABLE_VALUE(uint8_t, page)
+            TEMPLATABLE_VALUE(uint8_t, address)
+
+            void set_function(uint8_t function) { function_ = function; }
+            void set_width(uint8_t width) { width_ = width; }
+            void set_priority(CommandPriority priority) { priority_ = priority; }
+            void set_response_trigger(Trigger<uint16_t> *trigger) { response_trigger_ = trigger; }
+
+            void play(Ts... x) override
+            {
+                auto *trigger = this->response_trigger_;
+                this->parent_->queue_command_(CenturyPumpCommand::create_read_command(this->parent_, this->function_, this->page_.value(x...), this->address_.value(x...), this->width_, [trigger](CenturyVSPump *pump, uint16_t value)
+                                                                                      {
+                    if (trigger != nullptr)
+                        trigger->trigger(value); }),
+                                              this->priority_);
+            }
+
+        protected:
+            uint8_t function_{0x45};
+            uint8_t width_{1};
+            CommandPriority priority_{PRIORITY_NORMAL};
+            Trigger<uint16_t> *response_trigger_{nullptr};
+        };
+
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename... Ts>
+        class WriteRegisterAction : public Action<Ts...>, public Parented<CenturyVSPump>
+        {
+        public:
+            TEMPLATABLE_VALUE(uint8_t, page)
+            TEMPLATABLE_VALUE(uint8_t, address)
+            TEMPLATABLE_VALUE(uint16_t, value)
+
+            void set_width(uint8_t width) { width_ = width; }
+            void set_store_to_flash(bool store) { store_to_flash_ = store; }
+            void set_priority(CommandPriority priority) { priority_ = priority; }
+            void set_response_trigger(Trigger<> *trigger) { response_trigger_ = trigger; }
+
+            void play(Ts... x) override
+            {
+                auto *trigger = this->response_trigger_;
+                bool store = this->store_to_flash_;
+                CommandPriority priority = this->priority_;
+                auto on_confirmation = [trigger, store, priority](CenturyVSPump *pump)
+                {
+                    if (store)
+                        pump->queue_command_(CenturyPumpCommand::create_store_config_command(pump, [](CenturyVSPump *pump) {}), priority);
+                    if (trigger != nullptr)
+                        trigger->trigger();
+                };
+
+                uint8_t page = this->page_.value(x...);
+                uint8_t address = this->address_.value(x...);
+                uint16_t value = this->value_.value(x...);
+                if (this->width_ == 1 && value > 0xFF)
+                {
+                    ESP_LOGW(TAG, "Value %u does not fit a 1 byte register (page %d, addr %d), not written", value, page, address);
+                    return;
+                }
+                if (this->width_ > 1)
+                    this->parent_->queue_command_(CenturyPumpCommand::create_config_write_uint16_command(this->parent_, page, address, value, on_confirmation), priority);
+                else
+                    this->parent_->queue_command_(CenturyPumpCommand::create_config_write_command(this->parent_, page, address, (uint8_t)value, on_confirmation), priority);
+            }
+
+        protected:
+            uint8_t width_{1};
+            bool store_to_flash_{false};
+            CommandPriority priority_{PRIORITY_NORMAL};
+            Trigger<> *response_trigger_{nullptr};
+        };
+
+    }
+}
@@ -0,0 +1,68 @@
+from esphome.components import binary_sensor
+import esphome.config_validation as cv
+import esphome.codegen as cg
+
+from esphome.const import (
+    CONF_TYPE,
+    DEVICE_CLASS_CONNECTIVITY,
+    DEVICE_CLASS_PROBLEM,
+    DEVICE_CLASS_RUNNING,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+)
+from esphome.cpp_helpers import logging
+
+from .. import (
+    CenturyVSPump,
+    CenturyVSPumpItemSchema,
+    register_centuryvspump_code,
+    CODE_MOTOR_STATUS,
+)
+from ..const import (
+    CONF_CENTURY_VS_PUMP_ID,
+)
+
+DEPENDENCIES = ["centuryvspump"]
+CODEOWNERS = ["@gazoodle"]
+
+_LOGGER = logging.getLogger(__name__)
+
+BINARY_SENSOR_TYPE_ONLINE = "online"
+BINARY_SENSOR_TYPE_RUNNING = "running"
+BINARY_SENSOR_TYPE_FAULT = "fault"
+
+PUMP_ID_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_CENTURY_VS_PUMP_ID): cv.use_id(CenturyVSPump),
+    }
+)
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        BINARY_SENSOR_TYPE_ONLINE: binary_sensor.binary_sensor_schema(
+            device_class=DEVICE_CLASS_CONNECTIVITY,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(PUMP_ID_SCHEMA),
+        # Decoded from the motor status code, published only when it changes
+        BINARY_SENSOR_TYPE_RUNNING: binary_sensor.binary_sensor_schema(
+            device_class=DEVICE_CLASS_RUNNING,
+        ).extend(CenturyVSPumpItemSchema),
+        BINARY_SENSOR_TYPE_FAULT: binary_sensor.binary_sensor_schema(
+            device_class=DEVICE_CLASS_PROBLEM,
+        ).extend(CenturyVSPumpItemSchema),
+    },
+    lower=True,
+)
+
+
+async def to_code(config):
+    var = await binary_sensor.new_binary_sensor(config)
+    paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
+
+    if config[CONF_TYPE] == BINARY_SENSOR_TYPE_ONLINE:
+        cg.add(paren.set_online_binary_sensor(var))
+    elif config[CONF_TYPE] == BINARY_SENSOR_TYPE_RUNNING:
+        cg.add(paren.set_running_binary_sensor(var))
+        register_centuryvspump_code(config, CODE_MOTOR_STATUS)
+    elif config[CONF_TYPE] == BINARY_SENSOR_TYPE_FAULT:
+        cg.add(paren.set_fault_binary_sensor(var))
+        register_centuryvspump_code(config, CODE_MOTOR_STATUS)
@@ -1,3 +1,16 @@
 CONF_CENTURY_VS_PUMP_ID = "century_vs_pump_id"
 CONF_PAGE = "page"
 CONF_SCALE = "scale"
+CONF_POLL_CLASS = "poll_class"
+CONF_SLOW_POLL_DIVIDER = "slow_poll_divider"
+CONF_DIAGNOSTICS_WINDOW = "diagnostics_window"
+CONF_OFFLINE_AFTER = "offline_after"
+CONF_PROBE_INTERVAL = "probe_interval"
+CONF_MAX_PROBE_INTERVAL = "max_probe_interval"
+CONF_STORE_TO_FLASH = "store_to_flash"
+CONF_WIDTH = "width"
+CONF_PRIORITY = "priority"
+CONF_ON_RESPONSE = "on_response"
+CONF_IO_TASK = "io_task"
+CONF_RESPONSE_TIMEOUT = "response_timeout"
+CONF_MODBUS_ID = "modbus_id"
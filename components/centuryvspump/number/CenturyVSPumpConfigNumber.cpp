@@ -6,19 +6,13 @@ namespace esphome
     {
         static const char *const TAG = "century_vs_pump.config";
 
-        CenturyPumpCommand CenturyVSPumpConfigNumber::create_command()
-        {
-            return CenturyPumpCommand::create_config_read_command(pump_, page_, address_, [this](CenturyVSPump *pump, uint8_t value)
-                                                                  { this->publish_state((float)value + offset_); });
-        }
-
         void CenturyVSPumpConfigNumber::control(float value)
         {
-            uint8_t byte_value = (uint8_t)(value - offset_);
-            ESP_LOGD(TAG, "Set config page %d, addr %d to %d", page_, address_, byte_value);
+            uint8_t byte_value = (uint8_t)(value - register_->offset);
+            ESP_LOGD(TAG, "Set config page %d, addr %d to %d", register_->page, register_->address, byte_value);
 
             // State published only on pump confirmation, not optimistically
-            pump_->queue_command_(CenturyPumpCommand::create_config_write_command(pump_, page_, address_, byte_value, [this, value](CenturyVSPump *pump)
+            pump_->queue_command_(CenturyPumpCommand::create_config_write_command(pump_, register_->page, register_->address, byte_value, [this, value](CenturyVSPump *pump)
                                                                                    {
                 this->publish_state(value);
                 if (store_to_flash_)
@@ -27,7 +21,7 @@ namespace esphome
                     pump_->queue_command_(CenturyPumpCommand::create_store_config_command(pump_, [](CenturyVSPump *pump)
                                                                                           { ESP_LOGD(TAG, "Config stored successfully"); }));
                 } }));
-            pump_->update();
+            pump_->poll_registers_(false);
         }
     }
 }
@@ -2,7 +2,6 @@
 
 #include "esphome/components/centuryvspump/CenturyVSPump.h"
 #include "esphome/components/number/number.h"
-#include "esphome/core/component.h"
 
 namespace esphome
 {
@@ -10,23 +9,16 @@ namespace esphome
 
     namespace century_vs_pump
     {
-        class CenturyVSPumpConfigNumber : public CenturyPumpItemBase, public Component, public Number
+        // Page, address and offset come from the register table entry
+        class CenturyVSPumpConfigNumber : public CenturyPumpTargetBase, public Number
         {
         public:
-            CenturyVSPumpConfigNumber(uint8_t page, uint8_t address)
-                : CenturyPumpItemBase(), page_(page), address_(address) {}
-
             void set_store_to_flash(bool store) { store_to_flash_ = store; }
-            void set_offset(int16_t offset) { offset_ = offset; }
 
-            CenturyPumpCommand create_command() override;
             void control(float value) override;
 
         private:
-            uint8_t page_;
-            uint8_t address_;
             bool store_to_flash_{true};
-            int16_t offset_{0};
         };
     }
 }
@@ -6,19 +6,13 @@ namespace esphome
     {
         static const char *const TAG = "century_vs_pump.config16";
 
-        CenturyPumpCommand CenturyVSPumpConfigNumber16::create_command()
-        {
-            return CenturyPumpCommand::create_config_read_uint16_command(pump_, page_, address_, [this](CenturyVSPump *pump, uint16_t value)
-                                                                         { this->publish_state((float)value); });
-        }
-
         void CenturyVSPumpConfigNumber16::control(float value)
         {
             uint16_t uint16_value = (uint16_t)value;
-            ESP_LOGD(TAG, "Set config16 page %d, addr %d to %d", page_, address_, uint16_value);
+            ESP_LOGD(TAG, "Set config16 page %d, addr %d to %d", register_->page, register_->address, uint16_value);
 
             // State published only on pump confirmation, not optimistically
-            pump_->queue_command_(CenturyPumpCommand::create_config_write_uint16_command(pump_, page_, address_, uint16_value, [this, value](CenturyVSPump *pump)
+            pump_->queue_command_(CenturyPumpCommand::create_config_write_uint16_command(pump_, register_->page, register_->address, uint16_value, [this, value](CenturyVSPump *pump)
                                                                                           {
                 this->publish_state(value);
                 if (store_to_flash_)
@@ -27,7 +21,7 @@ namespace esphome
                     pump_->queue_command_(CenturyPumpCommand::create_store_config_command(pump_, [](CenturyVSPump *pump)
                                                                                           { ESP_LOGD(TAG, "Config stored successfully"); }));
                 } }));
-            pump_->update();
+            pump_->poll_registers_(false);
         }
     }
 }
@@ -2,7 +2,6 @@
 
 #include "esphome/components/centuryvspump/CenturyVSPump.h"
 #include "esphome/components/number/number.h"
-#include "esphome/core/component.h"
 
 namespace esphome
 {
@@ -10,17 +9,11 @@ namespace esphome
 
     namespace century_vs_pump
     {
-        class CenturyVSPumpDemandNumber : public CenturyPumpItemBase, public Component, public Number
+        class CenturyVSPumpDemandNumber : public CenturyPumpTargetBase, public Number
         {
         public:
-            CenturyVSPumpDemandNumber() : CenturyPumpItemBase() {}
-
-            // void write_state(bool state) override;
-            CenturyPumpCommand create_command() override;
             void control(float value) override;
-
-        private:
         };
 
     }
-}
\ No newline at end of file
+}
@@ -15,10 +15,14 @@ from esphome.cpp_helpers import logging
 from .. import (
     century_vs_pump_ns,
     CenturyVSPumpItemSchema,
+    register_centuryvspump_item,
+    FUNCTION_CONFIG,
+    FUNCTION_READ_SENSOR,
+    TARGET_NUMBER,
 )
 from ..const import (
-    CONF_CENTURY_VS_PUMP_ID,
     CONF_PAGE,
+    CONF_STORE_TO_FLASH,
 )
 
 DEPENDENCIES = ["centuryvspump"]
@@ -26,7 +30,6 @@ CODEOWNERS = ["@gazoodle"]
 
 _LOGGER = logging.getLogger(__name__)
 
-CONF_STORE_TO_FLASH = "store_to_flash"
 CONF_OFFSET = "offset"
 
 # Number types - users specify page/address/offset in YAML
@@ -35,15 +38,15 @@ NUMBER_TYPE_CONFIG = "config"
 NUMBER_TYPE_CONFIG16 = "config16"
 
 CenturyVSPumpDemandNumber = century_vs_pump_ns.class_(
-    "CenturyVSPumpDemandNumber", cg.Component, number.Number
+    "CenturyVSPumpDemandNumber", number.Number
 )
 
 CenturyVSPumpConfigNumber = century_vs_pump_ns.class_(
-    "CenturyVSPumpConfigNumber", cg.Component, number.Number
+    "CenturyVSPumpConfigNumber", number.Number
 )
 
 CenturyVSPumpConfigNumber16 = century_vs_pump_ns.class_(
-    "CenturyVSPumpConfigNumber16", cg.Component, number.Number
+    "CenturyVSPumpConfigNumber16", number.Number
 )
 
 # Common number options for min/max/step
@@ -55,7 +58,6 @@ NUMBER_OPTIONS = {
 
 DEMAND_SCHEMA = (
     number.number_schema(CenturyVSPumpDemandNumber)
-    .extend(cv.COMPONENT_SCHEMA)
     .extend(CenturyVSPumpItemSchema)
     .extend(NUMBER_OPTIONS)
     .extend(
@@ -67,7 +69,6 @@ DEMAND_SCHEMA = (
 
 CONFIG_SCHEMA_BASE = (
     number.number_schema(CenturyVSPumpConfigNumber)
-    .extend(cv.COMPONENT_SCHEMA)
     .extend(CenturyVSPumpItemSchema)
     .extend(NUMBER_OPTIONS)
     .extend(
@@ -76,14 +77,15 @@ CONFIG_SCHEMA_BASE = (
             cv.Required(CONF_PAGE): cv.int_range(min=0, max=255),
             cv.Required(CONF_ADDRESS): cv.int_range(min=0, max=255),
             cv.Optional(CONF_STORE_TO_FLASH, default=True): cv.boolean,
-            cv.Optional(CONF_OFFSET, default=0): cv.int_,
+            cv.Optional(CONF_OFFSET, default=0): cv.int_range(
+                min=-32768, max=32767
+            ),
         }
     )
 )
 
 CONFIG16_SCHEMA_BASE = (
     number.number_schema(CenturyVSPumpConfigNumber16)
-    .extend(cv.COMPONENT_SCHEMA)
     .extend(CenturyVSPumpItemSchema)
     .extend(NUMBER_OPTIONS)
     .extend(
@@ -132,8 +134,11 @@ async def to_code(config):
             kwargs["step"] = 50
 
         var = cg.new_Pvariable(config[CONF_ID])
-        await cg.register_component(var, config)
         await number.register_number(var, config, **kwargs)
+        # Demand readback is sensor page 0, address 3, RPM * 4
+        await register_centuryvspump_item(
+            var, config, TARGET_NUMBER, FUNCTION_READ_SENSOR, address=3, width=2, scale=4
+        )
 
     elif num_type == NUMBER_TYPE_CONFIG16:
         # Defaults for config16: uint16 range, step=1
@@ -144,13 +149,18 @@ async def to_code(config):
         if "step" not in kwargs:
             kwargs["step"] = 1
 
-        page = config[CONF_PAGE]
-        address = config[CONF_ADDRESS]
-
-        var = cg.new_Pvariable(config[CONF_ID], page, address)
-        await cg.register_component(var, config)
+        var = cg.new_Pvariable(config[CONF_ID])
         await number.register_number(var, config, **kwargs)
         cg.add(var.set_store_to_flash(config[CONF_STORE_TO_FLASH]))
+        await register_centuryvspump_item(
+            var,
+            config,
+            TARGET_NUMBER,
+            FUNCTION_CONFIG,
+            page=config[CONF_PAGE],
+            address=config[CONF_ADDRESS],
+            width=2,
+        )
 
     else:  # NUMBER_TYPE_CONFIG
         # Defaults for config: uint8 range, step=1
@@ -161,16 +171,16 @@ async def to_code(config):
         if "step" not in kwargs:
             kwargs["step"] = 1
 
-        page = config[CONF_PAGE]
-        address = config[CONF_ADDRESS]
-        offset = config.get(CONF_OFFSET, 0)
-
-        var = cg.new_Pvariable(config[CONF_ID], page, address)
-        await cg.register_component(var, config)
+        var = cg.new_Pvariable(config[CONF_ID])
         await number.register_number(var, config, **kwargs)
         cg.add(var.set_store_to_flash(config[CONF_STORE_TO_FLASH]))
-        cg.add(var.set_offset(offset))
-
-    paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
-    cg.add(var.set_pump(paren))
-    cg.add(paren.add_item(var))
+        await register_centuryvspump_item(
+            var,
+            config,
+            TARGET_NUMBER,
+            FUNCTION_CONFIG,
+            page=config[CONF_PAGE],
+            address=config[CONF_ADDRESS],
+            width=1,
+            offset=config.get(CONF_OFFSET, 0),
+        )
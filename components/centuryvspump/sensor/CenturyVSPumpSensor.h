@@ -2,7 +2,6 @@
 
 #include "esphome/components/centuryvspump/CenturyVSPump.h"
 #include "esphome/components/sensor/sensor.h"
-#include "esphome/core/component.h"
 
 namespace esphome
 {
@@ -10,19 +9,9 @@ namespace esphome
 
     namespace century_vs_pump
     {
-        class CenturyVSPumpSensor : public CenturyPumpItemBase, public Component, public Sensor
+        // Publish target only; the pump polls the register table and publishes the value here
+        class CenturyVSPumpSensor : public CenturyPumpTargetBase, public Sensor
         {
-        public:
-            CenturyVSPumpSensor(uint8_t page, uint8_t address, uint16_t scale) : CenturyPumpItemBase(), page_(page), address_(address), scale_(scale)
-            {
-            }
-
-            CenturyPumpCommand create_command() override;
-
-        private:
-            uint8_t page_;
-            uint8_t address_;
-            uint16_t scale_;
         };
 
     }
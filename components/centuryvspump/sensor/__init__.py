@@ -2,12 +2,23 @@ from esphome.components import sensor
 import esphome.config_validation as cv
 import esphome.codegen as cg
 
-from esphome.const import CONF_ID, CONF_ADDRESS, CONF_TYPE
+from esphome.const import (
+    CONF_ID,
+    CONF_ADDRESS,
+    CONF_TYPE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+)
 from esphome.cpp_helpers import logging
 
 from .. import (
     century_vs_pump_ns,
+    CenturyVSPump,
     CenturyVSPumpItemSchema,
+    register_centuryvspump_item,
+    FUNCTION_READ_SENSOR,
+    TARGET_SENSOR,
 )
 from ..const import (
     CONF_CENTURY_VS_PUMP_ID,
@@ -22,43 +33,88 @@ _LOGGER = logging.getLogger(__name__)
 
 
 CenturyVSPumpSensor = century_vs_pump_ns.class_(
-    "CenturyVSPumpSensor", cg.Component, sensor.Sensor
+    "CenturyVSPumpSensor", sensor.Sensor
 )
 
-SENSOR_TYPE = century_vs_pump_ns.enum("Type")
+DiagnosticSensor = century_vs_pump_ns.enum("DiagnosticSensor")
+
+REGISTER_TYPES = ["rpm", "custom"]
 
-SENSOR_TYPES = {"rpm": SENSOR_TYPE.rpm, "custom": SENSOR_TYPE.custom}
+# Queue diagnostics published by the pump itself, not polled from a register
+DIAGNOSTIC_GAUGES = {
+    "command_queue_depth": DiagnosticSensor.DIAG_COMMAND_QUEUE_DEPTH,
+    "command_queue_high_water": DiagnosticSensor.DIAG_COMMAND_QUEUE_HIGH_WATER,
+    "response_queue_depth": DiagnosticSensor.DIAG_RESPONSE_QUEUE_DEPTH,
+    "response_queue_high_water": DiagnosticSensor.DIAG_RESPONSE_QUEUE_HIGH_WATER,
+    "queued_bytes": DiagnosticSensor.DIAG_QUEUED_BYTES,
+    "queued_bytes_high_water": DiagnosticSensor.DIAG_QUEUED_BYTES_HIGH_WATER,
+}
+DIAGNOSTIC_TOTALS = {
+    "commands_enqueued": DiagnosticSensor.DIAG_COMMANDS_ENQUEUED,
+    "commands_dropped": DiagnosticSensor.DIAG_COMMANDS_DROPPED,
+}
+DIAGNOSTIC_TYPES = {**DIAGNOSTIC_GAUGES, **DIAGNOSTIC_TOTALS}
 
-CONFIG_SCHEMA = cv.All(
-    sensor.sensor_schema(CenturyVSPumpSensor).extend(cv.COMPONENT_SCHEMA)
+REGISTER_SCHEMA = (
+    sensor.sensor_schema(CenturyVSPumpSensor)
     .extend(CenturyVSPumpItemSchema)
     .extend(
         {
             cv.GenerateID(): cv.declare_id(CenturyVSPumpSensor),
-            cv.Required(CONF_TYPE): cv.enum(SENSOR_TYPES),
-            cv.Optional(CONF_ADDRESS, default=0): cv.positive_int,
-            cv.Optional(CONF_PAGE, default=0): cv.positive_int,
-            cv.Optional(CONF_SCALE, default=1): cv.positive_int,
+            cv.Optional(CONF_ADDRESS, default=0): cv.uint8_t,
+            cv.Optional(CONF_PAGE, default=0): cv.uint8_t,
+            cv.Optional(CONF_SCALE, default=1): cv.int_range(min=1, max=65535),
         }
-    ),
+    )
+)
+
+
+def diagnostic_schema(state_class):
+    return sensor.sensor_schema(
+        accuracy_decimals=0,
+        state_class=state_class,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ).extend(
+        {
+            cv.GenerateID(CONF_CENTURY_VS_PUMP_ID): cv.use_id(CenturyVSPump),
+        }
+    )
+
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        **{t: REGISTER_SCHEMA for t in REGISTER_TYPES},
+        **{t: diagnostic_schema(STATE_CLASS_MEASUREMENT) for t in DIAGNOSTIC_GAUGES},
+        **{
+            t: diagnostic_schema(STATE_CLASS_TOTAL_INCREASING)
+            for t in DIAGNOSTIC_TOTALS
+        },
+    },
+    lower=True,
 )
 
 
 async def to_code(config):
+    if config[CONF_TYPE] in DIAGNOSTIC_TYPES:
+        var = await sensor.new_sensor(config)
+        paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
+        cg.add(paren.set_diagnostic_sensor(DIAGNOSTIC_TYPES[config[CONF_TYPE]], var))
+        return
+
     if config[CONF_TYPE] == "rpm":
         config[CONF_PAGE] = 0
         config[CONF_ADDRESS] = 0
         config[CONF_SCALE] = 4
 
-    var = cg.new_Pvariable(
-        config[CONF_ID],
-        config[CONF_PAGE],
-        config[CONF_ADDRESS],
-        config[CONF_SCALE],
-    )
-    await cg.register_component(var, config)
+    var = cg.new_Pvariable(config[CONF_ID])
     await sensor.register_sensor(var, config)
-
-    paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
-    cg.add(var.set_pump(paren))
-    cg.add(paren.add_item(var))
+    await register_centuryvspump_item(
+        var,
+        config,
+        TARGET_SENSOR,
+        FUNCTION_READ_SENSOR,
+        page=config[CONF_PAGE],
+        address=config[CONF_ADDRESS],
+        width=2,
+        scale=config[CONF_SCALE],
+    )
@@ -2,7 +2,6 @@
 
 #include "esphome/components/centuryvspump/CenturyVSPump.h"
 #include "esphome/components/switch/switch.h"
-#include "esphome/core/component.h"
 
 namespace esphome
 {
@@ -10,16 +9,11 @@ namespace esphome
 
     namespace century_vs_pump
     {
-        class CenturyVSPumpRunSwitch : public CenturyPumpItemBase, public Component, public Switch
+        class CenturyVSPumpRunSwitch : public CenturyPumpTargetBase, public Switch
         {
         public:
-            CenturyVSPumpRunSwitch() : CenturyPumpItemBase() {}
-
             void write_state(bool state) override;
-            CenturyPumpCommand create_command() override;
-
-        private:
         };
 
     }
-}
\ No newline at end of file
+}
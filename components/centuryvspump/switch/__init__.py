@@ -2,15 +2,15 @@ from esphome.components import switch
 import esphome.config_validation as cv
 import esphome.codegen as cg
 
-from esphome.const import CONF_ID, CONF_ADDRESS
+from esphome.const import CONF_ID
 from esphome.cpp_helpers import logging
 
 from .. import (
     century_vs_pump_ns,
     CenturyVSPumpItemSchema,
-)
-from ..const import (
-    CONF_CENTURY_VS_PUMP_ID,
+    register_centuryvspump_item,
+    FUNCTION_STATUS,
+    TARGET_SWITCH,
 )
 
 DEPENDENCIES = ["centuryvspump"]
@@ -20,12 +20,12 @@ _LOGGER = logging.getLogger(__name__)
 
 
 CenturyVSPumpRunSwitch = century_vs_pump_ns.class_(
-    "CenturyVSPumpRunSwitch", cg.Component, switch.Switch  # , SensorItem
+    "CenturyVSPumpRunSwitch", switch.Switch
 )
 
 
 CONFIG_SCHEMA = cv.All(
-    switch.switch_schema(CenturyVSPumpRunSwitch).extend(cv.COMPONENT_SCHEMA)
+    switch.switch_schema(CenturyVSPumpRunSwitch)
     .extend(CenturyVSPumpItemSchema)
     .extend(
         {
@@ -36,12 +36,6 @@ CONFIG_SCHEMA = cv.All(
 
 
 async def to_code(config):
-    var = cg.new_Pvariable(
-        config[CONF_ID],
-    )
-    await cg.register_component(var, config)
+    var = cg.new_Pvariable(config[CONF_ID])
     await switch.register_switch(var, config)
-
-    paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
-    cg.add(var.set_pump(paren))
-    cg.add(paren.add_item(var))
+    await register_centuryvspump_item(var, config, TARGET_SWITCH, FUNCTION_STATUS)
@@ -0,0 +1,49 @@
+from esphome.components import text_sensor
+import esphome.config_validation as cv
+import esphome.codegen as cg
+
+from esphome.const import CONF_TYPE
+from esphome.cpp_helpers import logging
+
+from .. import (
+    century_vs_pump_ns,
+    CenturyVSPumpItemSchema,
+    register_centuryvspump_code,
+    CODE_MOTOR_STATUS,
+    CODE_PRIME_STATUS,
+    CODE_PREVIOUS_FAULT,
+)
+from ..const import (
+    CONF_CENTURY_VS_PUMP_ID,
+)
+
+DEPENDENCIES = ["centuryvspump"]
+CODEOWNERS = ["@gazoodle"]
+
+_LOGGER = logging.getLogger(__name__)
+
+CodeTable = century_vs_pump_ns.enum("CodeTable")
+
+# Decoded natively from the pump's code tables, published only when the code changes
+TEXT_SENSOR_TYPES = {
+    "motor_status": CODE_MOTOR_STATUS,
+    "prime_status": CODE_PRIME_STATUS,
+    "previous_fault": CODE_PREVIOUS_FAULT,
+}
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        t: text_sensor.text_sensor_schema().extend(CenturyVSPumpItemSchema)
+        for t in TEXT_SENSOR_TYPES
+    },
+    lower=True,
+)
+
+
+async def to_code(config):
+    var = await text_sensor.new_text_sensor(config)
+    paren = await cg.get_variable(config[CONF_CENTURY_VS_PUMP_ID])
+
+    code = TEXT_SENSOR_TYPES[config[CONF_TYPE]]
+    cg.add(paren.set_code_text_sensor(getattr(CodeTable, code), var))
+    register_centuryvspump_code(config, code)